@@ -19,16 +19,29 @@
 
 /*!
   \brief Class representing the integrand of the 2. order Cahn Hilliard problem.
+
+  \details The integration point methods are re-entrant, such that the element
+  loop may be executed by several threads. The history field is sized in
+  initIntegration(), and is within the element loop written only at the
+  slot \a fe.iGP of the current point. The tensile energy is read only.
+  Each additional thread evaluates its own copy of the initial crack function.
 */
 
 class CahnHilliard : public IntegrandBase
 {
 public:
+  //! \brief Enum defining which parts of the system to assemble.
+  //! \details The stationary part consists of the unit mass matrix, the
+  //! gradient terms and the right-hand-side vector, which only depend on the
+  //! mesh and the smearing factor. The history part is the mass matrix
+  //! weighted by the history field, which changes in every time step.
+  enum AssemblyPart { FULL, STATIONARY, HISTORY };
+
   //! \brief The constructor initializes all pointers to zero.
   //! \param[in] n Number of spatial dimensions
   CahnHilliard(unsigned short int n);
-  //! \brief Empty destructor.
-  virtual ~CahnHilliard() {}
+  //! \brief The destructor deletes the initial crack functions.
+  virtual ~CahnHilliard() { this->clearInitialCrack(); }
 
   //! \brief Parses a data section from an XML element.
   virtual bool parse(const TiXmlElement* elem);
@@ -74,10 +87,13 @@ public:
   //! \brief Sets the pointer to the tensile energy buffer.
   void setTensileEnergy(const RealArray* tens) { tensileEnergy = tens; }
 
+  //! \brief Defines which parts of the system to assemble.
+  void setAssemblyPart(AssemblyPart p) { part = p; }
+
   //! \brief Returns the initial crack function.
   RealFunc* initCrack() { return initial_crack; }
   //! \brief Clears the initial crack function (used after first time step).
-  void clearInitialCrack() { delete initial_crack; initial_crack = nullptr; }
+  void clearInitialCrack();
 
   //! \brief Returns a pointer to an Integrand for solution norm evaluation.
   //! \note The Integrand object is allocated dynamically and has to be deleted
@@ -91,6 +107,8 @@ public:
   double getSmearingFactor() const { return smearing; }
   //! \brief Scale the smearing factor, for use during initial refinement cycle.
   double scaleSmearing(double s) { return smearing *= s; }
+  //! \brief Assigns the smearing factor, e.g., on restart.
+  void setSmearingFactor(double s) { smearing = s; }
 
 protected:
   double Gc;       //!< Fracture energy density
@@ -99,10 +117,15 @@ protected:
   double stabk;    //!< Stabilization parameter
   double scale2nd; //!< Scaling factor in front of second order term
 
+  AssemblyPart part; //!< Which parts of the system to assemble
+
 private:
-  RealFunc*        initial_crack; //!< For generating initial history field
-  const RealArray* tensileEnergy; //!< Tensile energy from elasticity solver
-  int              Lnorm;         //!< Which L-norm to integrate
+  RealFunc*              initial_crack; //!< For generating initial history
+  std::string            crackFunc;     //!< Initial crack function definition
+  std::string            crackType;     //!< Initial crack function type
+  std::vector<RealFunc*> threadCrack;   //!< Initial crack copies for threads
+  const RealArray*       tensileEnergy; //!< Tensile energy from elasticity
+  int                    Lnorm;         //!< Which L-norm to integrate
 
 public:
   mutable RealArray historyField; //!< History field for tensile energy
@@ -0,0 +1,142 @@
+// $Id$
+//==============================================================================
+//!
+//! \file Checkpoint.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author SINTEF
+//!
+//! \brief Binary checkpoint files for restart of the fracture simulators.
+//!
+//==============================================================================
+
+#ifndef _CHECKPOINT_H
+#define _CHECKPOINT_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+
+/*!
+  \brief Writer of binary checkpoint files.
+
+  \details A checkpoint file starts with the 8-character tag \a IFEMFRAC and
+  the format version, followed by a sequence of named sections. Each section
+  consists of the name, the data type, the number of items, the CRC-32
+  checksum of the data, zero padding and the data. The data of each section
+  starts at a multiple of the page size, such that it can be mapped directly
+  into memory. Counts are stored as sections without data, where the number
+  of items is the value. The last section is named \a END.
+  The file is written under a temporary name and renamed by close(), such
+  that an interrupted write never replaces the previous checkpoint.
+*/
+
+class CheckpointWriter
+{
+public:
+  //! \brief The constructor opens the temporary file.
+  explicit CheckpointWriter(const std::string& fileName);
+  //! \brief The destructor removes the temporary file if not closed.
+  ~CheckpointWriter();
+
+  //! \brief Writes a section of double values.
+  bool write(const std::string& name, const std::vector<double>& data);
+  //! \brief Writes a section of integer values.
+  bool write(const std::string& name, const std::vector<int>& data);
+  //! \brief Writes a section with a single double value.
+  bool write(const std::string& name, double value);
+  //! \brief Writes a section of string key/value pairs.
+  bool write(const std::string& name,
+             const std::map<std::string,std::string>& data);
+  //! \brief Writes a count, e.g., the number of arrays in a sequence.
+  bool writeCount(const std::string& name, uint64_t n);
+
+  //! \brief Terminates the file, and renames it to the checkpoint file name.
+  bool close();
+
+private:
+  //! \brief Writes a section.
+  bool write(const std::string& name, uint32_t type,
+             const void* data, uint64_t n, size_t size);
+
+  std::string   fName; //!< Name of the checkpoint file
+  std::ofstream os;    //!< The temporary output file
+};
+
+
+/*!
+  \brief Reader of binary checkpoint files.
+
+  \details The file is memory-mapped on construction, where only the section
+  headers are read. The data of a section is copied directly from the mapping
+  into the output array when read, after its checksum has been verified.
+  Thus, the file is never held in memory in addition to the restored state,
+  and only the pages of the sections actually read are loaded from disk.
+*/
+
+class CheckpointReader
+{
+public:
+  //! \brief The constructor reads and verifies the checkpoint file.
+  explicit CheckpointReader(const std::string& fileName);
+  //! \brief The destructor unmaps the file.
+  ~CheckpointReader();
+
+  //! \brief Returns \e true if the file was read successfully.
+  bool isValid() const { return valid; }
+  //! \brief Returns \e true if the named section exists.
+  bool has(const std::string& name) const;
+
+  //! \brief Reads a section of double values.
+  bool read(const std::string& name, std::vector<double>& data) const;
+  //! \brief Reads a section of integer values.
+  bool read(const std::string& name, std::vector<int>& data) const;
+  //! \brief Reads a section with a single double value.
+  bool read(const std::string& name, double& value) const;
+  //! \brief Reads a section of string key/value pairs.
+  bool read(const std::string& name,
+            std::map<std::string,std::string>& data) const;
+  //! \brief Reads a count written by CheckpointWriter::writeCount().
+  bool readCount(const std::string& name, size_t& n) const;
+
+  //! \brief Returns a pointer to the data of a section of double values.
+  //! \param[in] name Name of the section
+  //! \param[out] n Number of values in the section
+  //! \details The data is not copied, and the pointer is valid until the
+  //! reader is destroyed.
+  const double* getDoubles(const std::string& name, size_t& n) const;
+
+private:
+  //! \brief Disallow copying, since the reader owns the mapping.
+  CheckpointReader(const CheckpointReader&) = delete;
+  //! \brief Disallow assignment, since the reader owns the mapping.
+  CheckpointReader& operator=(const CheckpointReader&) = delete;
+
+  //! \brief A section of the checkpoint file.
+  struct Section
+  {
+    uint32_t type;   //!< Data type
+    uint32_t crc;    //!< Checksum of the data
+    uint64_t count;  //!< Number of items
+    uint64_t offset; //!< File offset of the data
+    uint64_t size;   //!< Size of the data in bytes
+    mutable bool verified; //!< If \e true, the checksum has been verified
+  };
+
+  //! \brief Returns the data of the named section if it has the given type.
+  const char* find(const std::string& name, uint32_t type,
+                   const Section*& sec) const;
+
+  std::string fName; //!< Name of the checkpoint file
+  std::map<std::string,Section> sections; //!< The sections of the file
+  const char*       base;   //!< The mapped file
+  size_t            length; //!< Size of the mapped file
+  std::vector<char> buffer; //!< The file contents, if mapping is unavailable
+  bool valid; //!< If \e true, the file was read successfully
+};
+
+#endif
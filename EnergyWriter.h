@@ -0,0 +1,82 @@
+// $Id$
+//==============================================================================
+//!
+//! \file EnergyWriter.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author SINTEF
+//!
+//! \brief Buffered writer for the time series of global energy quantities.
+//!
+//==============================================================================
+
+#ifndef _ENERGY_WRITER_H
+#define _ENERGY_WRITER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+
+/*!
+  \brief Buffered writer for the time series of global energy quantities.
+
+  \details The file is kept open during the simulation, and the rows are
+  buffered in memory and written every \a flushInc rows, and on destruction.
+  The text format is the one used for plotting, with one row per time step.
+  The binary format starts with the 8-character tag \a IFEMENRG followed by
+  the format version and the number of columns, as 32-bit integers, and
+  then the rows as native doubles. Use convert() to obtain the text format.
+*/
+
+class EnergyWriter
+{
+public:
+  //! \brief The constructor opens the file.
+  //! \param[in] fileName Name of the file to write
+  //! \param[in] binary If \e true, use the binary format
+  //! \param[in] flushInc Number of rows to buffer before writing
+  //! \param[in] append If \e true, append to an existing file
+  EnergyWriter(const std::string& fileName, bool binary, int flushInc,
+               bool append = false);
+  //! \brief The destructor writes the buffered rows.
+  ~EnergyWriter() { this->flush(); }
+
+  //! \brief Adds a row for a time step.
+  //! \param[in] t Time of the step
+  //! \param[in] values Energy quantities of the step
+  bool write(double t, const std::vector<double>& values);
+  //! \brief Writes the buffered rows to file.
+  //! \return \e false if the file could not be written
+  bool flush();
+  //! \brief Returns the size of the file, excluding the buffered rows.
+  std::streamoff getFileSize() { return file.tellp(); }
+
+  //! \brief Truncates a file to a size it had earlier.
+  //! \param[in] fileName Name of the file
+  //! \param[in] size Size in bytes to keep
+  //! \details Used on restart, to drop the rows written after the checkpoint.
+  //! A file that is missing or not larger than \a size is left untouched.
+  static bool truncate(const std::string& fileName, std::streamoff size);
+
+  //! \brief Converts a binary file to the text format.
+  //! \param[in] fileName Name of the binary file
+  //! \param os Output stream for the text format
+  static bool convert(const std::string& fileName, std::ostream& os);
+
+private:
+  //! \brief Writes a row in the text format.
+  static void writeText(std::ostream& os, const double* row, size_t ncol);
+
+  std::string         name;   //!< Name of the output file
+  std::ofstream       file;   //!< The output file
+  bool                binary; //!< If \e true, the binary format is used
+  bool                header; //!< If \e true, the header is to be written
+  size_t              nflush; //!< Number of rows to buffer before writing
+  size_t              ncol;   //!< Number of columns, including the time
+  size_t              nrow;   //!< Number of buffered rows
+  std::vector<double> rows;   //!< Buffered rows
+};
+
+#endif
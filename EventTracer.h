@@ -0,0 +1,77 @@
+// $Id$
+//==============================================================================
+//!
+//! \file EventTracer.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author SINTEF
+//!
+//! \brief Timeline tracing of the solution phases in Chrome trace format.
+//!
+//==============================================================================
+
+#ifndef _EVENT_TRACER_H
+#define _EVENT_TRACER_H
+
+#include <chrono>
+
+
+/*!
+  \brief Timeline tracer writing Chrome trace-event JSON.
+
+  \details The tracer writes one complete event per traced span, with the
+  start time and duration in microseconds since the trace file was opened.
+  Spans which are contained in each other are shown nested when the file is
+  loaded in chrome://tracing or https://ui.perfetto.dev.
+
+  The tracer is disabled unless open() has been called, in which case the
+  creation of a Span costs one test of a static flag only. The spans are
+  therefore only intended for the solution phases of a time step, and not
+  for the element or integration point level.
+*/
+
+class EventTracer
+{
+public:
+  //! \brief Clock type of the tracer.
+  typedef std::chrono::steady_clock Clock;
+
+  //! \brief Scope guard tracing the lifetime of a span.
+  class Span
+  {
+  public:
+    //! \brief The constructor starts the span if tracing is enabled.
+    //! \param[in] name Name of the span, must outlive the span
+    //! \param[in] step Time step to attach to the span, ignored if negative
+    explicit Span(const char* name, int step = -1)
+      : myName(enabled ? name : nullptr), myStep(step)
+    {
+      if (myName) t0 = Clock::now();
+    }
+    //! \brief The destructor writes the span if tracing is enabled.
+    ~Span() { if (myName) EventTracer::complete(myName,t0,myStep); }
+
+  private:
+    const char*       myName; //!< Span name, null if tracing is disabled
+    int               myStep; //!< Time step of the span
+    Clock::time_point t0;     //!< Start time of the span
+  };
+
+  //! \brief Opens the trace file and enables the tracing.
+  //! \param[in] fileName Name of the trace file
+  static bool open(const char* fileName);
+  //! \brief Returns \e true if tracing is enabled.
+  static bool isEnabled() { return enabled; }
+
+  //! \brief Writes a complete event for a span ending now.
+  //! \param[in] name Name of the span
+  //! \param[in] t0 Start time of the span
+  //! \param[in] step Time step to attach to the span, ignored if negative
+  static void complete(const char* name, Clock::time_point t0, int step = -1);
+
+private:
+  static bool enabled; //!< If \e true, the tracing is enabled
+};
+
+#endif
@@ -16,11 +16,19 @@
 
 #include "Elasticity.h"
 
-class Tensor4;
+class SymmTensor4;
 
 
 /*!
   \brief Class representing the integrand of elasticity problems with fracture.
+
+  \details The integration point methods of this class and its sub-classes
+  are re-entrant, such that the element loop may be executed by several
+  threads. All temporaries are local to the method invocation, and the
+  element vectors are stored in the LocalIntegral object of each element.
+  The mutable integration point buffers are sized outside the element loop,
+  in initIntegration() and setMode(), and are within the loop written only
+  at the slot \a fe.iGP of the current point.
 */
 
 class FractureElasticity : public Elasticity
@@ -39,8 +47,14 @@ public:
   //! \brief Sets the number of solution variables per node.
   void setVar(unsigned short int n) { npv = n; }
 
+  //! \brief Defines the solution mode before the element assembly is started.
+  //! \details This also invalidates the integration point state cache.
+  //! \param[in] mode The solution mode to use
+  virtual void setMode(SIM::SolutionMode mode);
+
   //! \brief Initializes the integrand with the number of integration points.
   //! \param[in] nGp Total number of interior integration points
+  //! \details This also empties the integration point state cache.
   virtual void initIntegration(size_t nGp, size_t);
 
   //! \brief Initializes current element for numerical integration.
@@ -84,6 +98,45 @@ public:
 
   //! \brief Returns a pointer to the Gauss-point tensile energy array.
   const RealArray* getTensileEnergy() const { return &myPhi; }
+  //! \brief Accepts the tensile energy of the last assembled iteration.
+  //! \details During the equilibrium iterations the tensile energy is written
+  //! to a separate buffer, such that unconverged iterates never reach the
+  //! phase field solver. This method swaps the two buffers, after which the
+  //! array returned by getTensileEnergy() holds the values of the last
+  //! stiffness or residual assembly. The RECOVERY assembly writes directly
+  //! into the array returned by getTensileEnergy() instead.
+  void commitTensileEnergy() { myPhi.swap(myPhiIt); }
+  //! \brief Restores the Gauss-point tensile energy, e.g., on restart.
+  //! \param[in] phi Tensile energy values, one for each integration point
+  void setTensileEnergy(const double* phi);
+
+  //! \brief Constitutive state at an integration point.
+  struct GPState
+  {
+    Vec3     X;         //!< Cartesian coordinates of the integration point
+    double   Gc;        //!< Stress degradation function value
+    double   Phi[4];    //!< Tensile, compressive, total and bulk energies
+    double   sigma[6];  //!< Stress tensor components, in SymmTensor order
+    unsigned version;   //!< Solution version this state was evaluated for
+  };
+
+  //! \brief Returns the cached constitutive state at an integration point.
+  //! \param[in] fe Finite element data of current integration point
+  //! \param[in] X Cartesian coordinates of current integration point
+  //! \param[in] Gc Stress degradation function value at current point
+  //! \return Pointer to the cached state, or null if it is not valid
+  //!
+  //! \details The state is cached in the RECOVERY assembly only, i.e., on the
+  //! converged solution, and is invalidated whenever the solution mode is set.
+  //! The coordinates and degradation function value must also match, since
+  //! the norms and secondary solutions may use other points, and the phase
+  //! field may have been updated since the state was cached.
+  //! Each setMode() increments the version of the cache, such that all
+  //! cached states become invalid, and initIntegration() empties it.
+  //! The cache is therefore inactive when the driver skips the RECOVERY
+  //! assembly, see SIMDynElasticity::setNewtonPhi(). The hits are counted by StepCounters.
+  const GPState* getState(const FiniteElement& fe, const Vec3& X,
+                          double Gc) const;
 
   //! \brief Returns the number of primary/secondary solution field components.
   //! \param[in] fld which field set to consider (1=primary, 2=secondary)
@@ -106,12 +159,29 @@ protected:
   //! \brief Evaluates the stress tensor and its derivative w.r.t. the strains.
   bool evalStress(double lambda, double mu, double Gc,
                   const SymmTensor& epsilon, double* Phi,
-                  SymmTensor& sigma, Tensor4* dSdE,
+                  SymmTensor& sigma, SymmTensor4* dSdE,
                   bool postProc = false) const;
 
   //! \brief Evaluates the stress degradation function \a g(c) at current point.
   double getStressDegradation(const Vector& N, const Vectors& eV) const;
 
+  //! \brief Returns the tensile energy buffer entry of an integration point.
+  //! \details The RECOVERY assembly writes to the committed buffer, whereas
+  //! all other assemblies write to the iteration buffer.
+  double& tensileEnergy(size_t iGP) const
+  {
+    return m_mode == SIM::RECOVERY ? myPhi[iGP] : myPhiIt[iGP];
+  }
+
+  //! \brief Caches the constitutive state at current integration point.
+  //! \param[in] fe Finite element data of current integration point
+  //! \param[in] X Cartesian coordinates of current integration point
+  //! \param[in] Gc Stress degradation function value
+  //! \param[in] Phi Tensile and compressive energy densities
+  //! \param[in] sigma Stress tensor components, in SymmTensor order
+  void storeState(const FiniteElement& fe, const Vec3& X, double Gc,
+                  const double* Phi, const RealArray& sigma) const;
+
 private:
   unsigned short int eC; //!< Zero-based index to element phase field vector
 
@@ -119,7 +189,11 @@ protected:
   double alpha;  //!< Relaxation factor for the crack phase field
   Vector myCVec; //!< Crack phase field values at nodal points
 
-  mutable RealArray myPhi; //!< Tensile energy density at integration points
+  mutable RealArray myPhi;   //!< Tensile energy density at integration points
+  mutable RealArray myPhiIt; //!< Tensile energy density of current iteration
+
+  mutable std::vector<GPState> myState; //!< Integration point state cache
+  unsigned int stateVersion; //!< Current version of the state cache
   Vectors&          mySol; //!< Primary solution vectors for current patch
 };
 
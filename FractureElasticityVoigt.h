@@ -63,10 +63,75 @@ protected:
                   SymmTensor* sigma, Matrix* dSdE,
                   bool postProc = false, bool printElm = false) const;
 
+  //! \brief Integrates the material stiffness matrix, EK += B^T*D*B*|J|*w.
+  //! \param EK The element stiffness matrix to add to
+  //! \param[in] dNdX Basis function gradients at current integration point
+  //! \param[in] D Symmetric constitutive matrix in Voigt notation
+  //! \param[in] detJxW Jacobian determinant times integration point weight
+  template<unsigned short int NSD>
+  static void addStiffness(Matrix& EK, const Matrix& dNdX,
+                           const double* D, double detJxW);
+
   friend class FractureElasticNorm;
 };
 
 
+/*!
+  \brief Class representing the integrand of elasticity problems with fracture.
+
+  \details This sub-class is specialized on the number of spatial dimensions.
+  The strains, stresses, the constitutive matrix and the nodal blocks of the
+  strain-displacement matrix are kept in fixed-size arrays at each integration
+  point, such that all loop bounds are compile-time constants.
+  The operations are not done in the same order as in the general
+  formulation, e.g., the tensile energy is evaluated from the positive strain
+  tensor instead of from the positive principal strains, so the results of
+  the two formulations agree to rounding only, and not bitwise.
+*/
+
+template<unsigned short int NSD>
+class FractureElasticityVoigtNSD : public FractureElasticityVoigt
+{
+public:
+  //! \brief Number of unique strain components.
+  static const unsigned short int NSTRC = NSD*(NSD+1)/2;
+
+  //! \brief The constructor invokes the parent class constructor only.
+  FractureElasticityVoigtNSD() : FractureElasticityVoigt(NSD) {}
+  //! \brief Constructor for integrands with a parent integrand.
+  //! \param parent The parent integrand of this one
+  FractureElasticityVoigtNSD(IntegrandBase* parent)
+    : FractureElasticityVoigt(parent,NSD) {}
+  //! \brief Empty destructor.
+  virtual ~FractureElasticityVoigtNSD() {}
+
+  //! \brief Evaluates the integrand at an interior point.
+  //! \param elmInt The local integral object to receive the contributions
+  //! \param[in] fe Finite element data of current integration point
+  //! \param[in] X Cartesian coordinates of current integration point
+  virtual bool evalInt(LocalIntegral& elmInt, const FiniteElement& fe,
+                       const Vec3& X) const;
+
+  //! \brief Evaluates the stress tensor and its derivative w.r.t. the strains.
+  //! \param[in] lambda Lame's first parameter
+  //! \param[in] mu Shear modulus
+  //! \param[in] Gc Stress degradation function value
+  //! \param[in] epsil Strain tensor components, in SymmTensor order
+  //! \param[out] Phi Tensile energy density
+  //! \param[out] sigma Stress tensor components, in SymmTensor order
+  //! \param[out] dSdE Constitutive matrix in Voigt notation (NSTRCxNSTRC)
+  static bool evalStressNSD(double lambda, double mu, double Gc,
+                            const double* epsil, double* Phi,
+                            double* sigma, double* dSdE);
+};
+
+//! \brief Closed-form 2D stress evaluation.
+template<> bool
+FractureElasticityVoigtNSD<2>::evalStressNSD(double, double, double,
+                                             const double*, double*,
+                                             double*, double*);
+
+
 /*!
   \brief Class representing the integrand of elasticity norms with fracture.
 */
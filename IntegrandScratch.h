@@ -0,0 +1,93 @@
+// $Id$
+//==============================================================================
+//!
+//! \file IntegrandScratch.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author SINTEF
+//!
+//! \brief Per-thread scratch buffers for integrand temporaries.
+//!
+//==============================================================================
+
+#ifndef _INTEGRAND_SCRATCH_H
+#define _INTEGRAND_SCRATCH_H
+
+#include "MatVec.h"
+#include <memory>
+
+class SymmTensor;
+
+
+/*!
+  \brief Per-thread pool of scratch buffers for integrand temporaries.
+
+  \details The integration point methods use a few matrices, vectors and
+  tensors which otherwise would be allocated on the heap and released again
+  for every point. These are instead taken from the pool of the calling
+  thread, where they keep their storage between the invocations, such that
+  no heap allocation takes place once all buffers have reached their size.
+
+  The buffers are identified by a slot index, and the caller owns its slots
+  until it returns. A method using the pool must therefore not call another
+  method using the same slots. The integration point methods use the matrix
+  and tensor slots, whereas the evalSol() methods gathering the element
+  vectors from the global solution use the vector slots only.
+
+  The number of buffer allocations is counted over all threads. A buffer
+  whose storage has been allocated or moved since the previous request
+  counts as one allocation. This way, also the allocations inside methods
+  resizing the buffers, e.g., the strain-displacement matrix, are detected,
+  although not until the next request of the buffer.
+*/
+
+class IntegrandScratch
+{
+public:
+  //! \brief Returns the scratch buffer pool of the calling thread.
+  static IntegrandScratch& get();
+
+  //! \brief Returns a matrix buffer, with unspecified size and content.
+  //! \param[in] idx 0-based slot index
+  Matrix& matrix(size_t idx);
+  //! \brief Returns a zero-initialized matrix buffer of the given size.
+  //! \param[in] idx 0-based slot index
+  //! \param[in] r Number of rows
+  //! \param[in] c Number of columns
+  Matrix& matrix(size_t idx, size_t r, size_t c);
+  //! \brief Returns a zero-initialized symmetric tensor buffer.
+  //! \param[in] idx 0-based slot index
+  //! \param[in] nsd Number of spatial dimensions
+  SymmTensor& tensor(size_t idx, unsigned short int nsd);
+  //! \brief Returns an array of vector buffers.
+  //! \param[in] n Number of vectors to use
+  //! \details The array has at least \a n vectors, of which the first \a n
+  //! are empty. The remaining vectors are owned by other callers.
+  Vectors& vectors(size_t n);
+
+  //! \brief Returns the number of buffer allocations in all threads.
+  static size_t getNoAllocations();
+
+private:
+  //! \brief The default constructor is private, use get() instead.
+  IntegrandScratch();
+  //! \brief The destructor is defined where SymmTensor is complete.
+  ~IntegrandScratch();
+
+  //! \brief Checks whether the storage of a buffer has moved.
+  //! \param last Previous storage address of the buffer
+  //! \param[in] curr Current storage address of the buffer
+  static void check(const void*& last, const void* curr);
+
+  std::vector<std::unique_ptr<Matrix>> mats; //!< Matrix buffers
+  std::vector<const void*> pMat; //!< Last storage address of matrix buffers
+
+  std::vector<std::unique_ptr<SymmTensor>> tens; //!< Tensor buffers
+  std::vector<const void*> pTen; //!< Last storage address of tensor buffers
+
+  Vectors                  vecs; //!< Vector buffers
+  std::vector<const void*> pVec; //!< Last storage address of vector buffers
+};
+
+#endif
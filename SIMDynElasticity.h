@@ -18,6 +18,9 @@
 #include "NewmarkSIM.h"
 #include "SIMElasticity.h"
 #include "FractureElasticityVoigt.h"
+#include "StepCounters.h"
+#include "EventTracer.h"
+#include "Checkpoint.h"
 #include "DataExporter.h"
 
 
@@ -30,7 +33,8 @@ class SIMDynElasticity : public SIMElasticity<Dim>
 {
 public:
   //! \brief Default constructor.
-  SIMDynElasticity() : SIMElasticity<Dim>(false), dSim(*this), vtfStep(0)
+  SIMDynElasticity() : SIMElasticity<Dim>(false), dSim(*this), vtfStep(0),
+                       newtonPhi(false)
   {
     Dim::myHeading = "Elasticity solver";
   }
@@ -86,6 +90,8 @@ public:
   //! \param nBlock Running result block counter
   bool saveStep(const TimeStep& tp, int& nBlock)
   {
+    EventTracer::Span span("Elasticity output",tp.step);
+
     double old = utl::zero_print_tol;
     utl::zero_print_tol = 1e-16;
     bool ok = this->savePoints(dSim.getSolution(),tp.time.t,tp.step);
@@ -118,31 +124,56 @@ public:
     if (Dim::msgLevel >= 1)
       IFEM::cout <<"\n  Solving the elasto-dynamics problem...";
 
-    if (dSim.solveStep(tp) != SIM::CONVERGED)
-      return false;
+    {
+      StepCounters::Timing timing(StepCounters::ELASTICITY_NEWTON);
+      EventTracer::Span span("Elasticity Newton solve",tp.step);
+      if (dSim.solveStep(tp) != SIM::CONVERGED)
+        return false;
+    }
+    // tp.iter is the number of iterations of the converged step
+    StepCounters::add(StepCounters::NEWTON_ITER,tp.iter);
 
+    this->commitTensileEnergy();
     return this->postSolve(tp);
   }
 
+  //! \brief Toggles the use of the tensile energy of the Newton iterations.
+  //! \details If \e true, the tensile energy of the last equilibrium
+  //! iteration is used instead of recomputing it on the converged solution.
+  //! The RECOVERY assembly is then skipped, and the integration point state
+  //! cache of the integrand is never filled.
+  void setNewtonPhi(bool useNewton) { newtonPhi = useNewton; }
+
   //! \brief Computes solution norms, etc. on the converged solution.
   bool postSolve(TimeStep& tp)
   {
-    // Update strain energy density for the converged solution
+    // Update strain energy density for the converged solution,
+    // unless the values from the last iteration are used
     this->setMode(SIM::RECOVERY);
-    if (!this->assembleSystem(tp.time,dSim.getSolutions()))
-      return false;
+    if (!newtonPhi)
+    {
+      EventTracer::Span span("Elasticity recovery",tp.step);
+      if (!this->assembleSystem(tp.time,dSim.getSolutions()))
+        return false;
+    }
 
     // Project the secondary solution field onto the geometry basis
     if (!Dim::opt.project.empty())
+    {
+      EventTracer::Span span("Elasticity projection",tp.step);
       if (!this->project(projSol,dSim.getSolution(),
                          Dim::opt.project.begin()->first))
         return false;
+    }
 
     Vectors gNorms;
     this->setQuadratureRule(Dim::opt.nGauss[1]);
-    if (!this->solutionNorms(tp.time,dSim.getSolutions(),gNorms,&eNorm))
-      return false;
-    else if (!gNorms.empty())
+    {
+      EventTracer::Span span("Elasticity norms",tp.step);
+      if (!this->solutionNorms(tp.time,dSim.getSolutions(),gNorms,&eNorm))
+        return false;
+    }
+    if (!gNorms.empty())
     {
       gNorm = gNorms.front();
       if (gNorm.size() > 0 && utl::trunc(gNorm(1)) != 0.0)
@@ -171,7 +202,9 @@ public:
   const Vector& getGlobalNorms() const { return gNorm; }
 
   //! \brief Dummy method.
-  void setEnergyFile(const std::string&) {}
+  void setEnergyFile(const char*, bool = false, int = 0) {}
+  //! \brief Dummy method.
+  void setCheckpointFile(const char*, int) {}
 
   //! \brief Returns a const reference to current solution vector.
   const Vector& getSolution(int idx = 0) const { return dSim.getSolution(idx); }
@@ -186,22 +219,86 @@ public:
       dSim.setSolution(dvec[i],i);
   }
 
+  //! \brief Writes the solution state to a checkpoint file.
+  bool writeCheckpoint(CheckpointWriter& chk) const
+  {
+    const Vectors& sol = dSim.getSolutions();
+    for (size_t i = 0; i < sol.size(); i++)
+      if (!chk.write("Elasticity/solution" + std::to_string(i),sol[i]))
+        return false;
+
+    return chk.write("Elasticity/tensileEnergy",*this->getTensileEnergy());
+  }
+
+  //! \brief Restores the solution state from a checkpoint file.
+  //! \details The model must have been refined to the mesh of the checkpoint.
+  bool readCheckpoint(const CheckpointReader& chk)
+  {
+    size_t nPhi = 0;
+    const double* phi = chk.getDoubles("Elasticity/tensileEnergy",nPhi);
+    if (!phi)
+      return false;
+    else if (nPhi != this->getTensileEnergy()->size())
+    {
+      std::cerr <<" *** SIMDynElasticity::readCheckpoint: Tensile energy has "
+                << nPhi <<" values, expected "
+                << this->getTensileEnergy()->size() << std::endl;
+      return false;
+    }
+
+    // Copy the solutions directly from the mapped checkpoint file into the
+    // solution vectors of the integrator, such that no other copy is made
+    Vectors& sol = dSim.theSolutions();
+    for (size_t i = 0; i < sol.size(); i++)
+    {
+      size_t nVal = 0;
+      const double* val = chk.getDoubles("Elasticity/solution" +
+                                         std::to_string(i),nVal);
+      if (!val)
+        return false;
+      else if (nVal != this->getNoDOFs())
+      {
+        std::cerr <<" *** SIMDynElasticity::readCheckpoint: Solution "<< i
+                  <<" has "<< nVal <<" values, expected "
+                  << this->getNoDOFs() << std::endl;
+        return false;
+      }
+      sol[i].assign(val,val+nVal);
+    }
+
+    // Copy the tensile energy directly from the mapped checkpoint file
+    static_cast<FractureElasticity*>(Dim::myProblem)->setTensileEnergy(phi);
+    return true;
+  }
+
   //! \brief Solves the linearized system of current iteration.
   //! \param[in] tp Time stepping parameters
   SIM::ConvStatus solveIteration(TimeStep& tp)
   {
-    return dSim.solveIteration(tp);
+    StepCounters::Timing timing(StepCounters::ELASTICITY_NEWTON);
+    EventTracer::Span span("Elasticity iteration",tp.step);
+    StepCounters::add(StepCounters::NEWTON_ITER);
+    SIM::ConvStatus status = dSim.solveIteration(tp);
+    if (status != SIM::FAILURE && status != SIM::DIVERGED)
+      this->commitTensileEnergy(); // the phase field uses this iterate
+    return status;
   }
 
   //! \brief Returns the maximum number of iterations.
   int getMaxit() const { return dSim.getMaxit(); }
 
 protected:
+  //! \brief Accepts the tensile energy of the last assembled iteration.
+  void commitTensileEnergy()
+  {
+    static_cast<FractureElasticity*>(Dim::myProblem)->commitTensileEnergy();
+  }
+
   //! \brief Returns the actual integrand.
   virtual Elasticity* getIntegrand()
   {
     if (!Dim::myProblem) // Using the Voigt formulation by default
-      Dim::myProblem = new FractureElasticityVoigt(Dim::dimension);
+      Dim::myProblem = new FractureElasticityVoigtNSD<Dim::dimension>();
     return static_cast<Elasticity*>(Dim::myProblem);
   }
 
@@ -226,11 +323,12 @@ protected:
   }
 
 private:
-  DynSIM dSim;    //!< Dynamic solution driver
-  Matrix projSol; //!< Projected secondary solution fields
-  Matrix eNorm;   //!< Element norm values
-  Vector gNorm;   //!< Global norm values
-  int    vtfStep; //!< VTF file step counter
+  DynSIM dSim;      //!< Dynamic solution driver
+  Matrix projSol;   //!< Projected secondary solution fields
+  Matrix eNorm;     //!< Element norm values
+  Vector gNorm;     //!< Global norm values
+  int    vtfStep;   //!< VTF file step counter
+  bool   newtonPhi; //!< If \e true, skip the RECOVERY assembly
 };
 
 #endif
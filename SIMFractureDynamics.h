@@ -15,11 +15,17 @@
 #define _SIM_FRACTURE_DYNAMICS_H_
 
 #include "SIMCoupled.h"
+#include "ASMstruct.h"
+#include "StepCounters.h"
+#include "EventTracer.h"
+#include "EnergyWriter.h"
+#include "Checkpoint.h"
 #ifdef HAS_LRSPLINE
 #include "ASMu2D.h"
 #include "LRSpline/LRSplineSurface.h"
 #endif
 #include <fstream>
+#include <memory>
 
 
 /*!
@@ -35,7 +41,9 @@ class SIMFracture : public Coupling<SolidSolver,PhaseSolver>
 public:
   //! \brief The constructor initializes the references to the two solvers.
   SIMFracture(SolidSolver& s1, PhaseSolver& s2, const std::string& inputfile)
-    : Coupling<SolidSolver,PhaseSolver>(s1,s2), infile(inputfile), aMin(0.0) {}
+    : Coupling<SolidSolver,PhaseSolver>(s1,s2), infile(inputfile),
+      binaryEnergy(false), energyFlush(1), energySize(-1), countSize(-1),
+      chkInterval(0), restarted(false), rereadInput(false), aMin(0.0) {}
   //! \brief Empty destructor.
   virtual ~SIMFracture() {}
 
@@ -49,41 +57,244 @@ public:
     this->S2.setTensileEnergy(this->S1.getTensileEnergy());
   }
 
+  //! \brief Advances the time step one step forward.
+  //! \details It also marks the start of the step in the event trace.
+  virtual bool advanceStep(TimeStep& tp)
+  {
+    if (EventTracer::isEnabled())
+      stepStart = EventTracer::Clock::now();
+    return this->Coupling<SolidSolver,PhaseSolver>::advanceStep(tp);
+  }
+
   //! \brief Saves the converged results to VTF-file of a given time step.
   //! \details It also writes global energy quantities to file for plotting.
+  //! The performance counters are reset for the next step in any case.
   virtual bool saveStep(const TimeStep& tp, int& nBlock)
   {
     if (!energFile.empty() && this->S1.getProcessAdm().getProcId() == 0)
     {
-      std::ofstream os(energFile, tp.step == 1 ? std::ios::out : std::ios::app);
-
-      if (tp.step == 1)
-        os <<"#t eps_e external_energy eps+ eps- eps_b |c|"
-           <<" eps_d-eps_d(0) eps_d"<< std::endl;
+      EventTracer::Span span("Energy output",tp.step);
+
+      if (!energy || tp.step == 1)
+      {
+        // After a restart, continue the files of the previous run,
+        // from where they were when the checkpoint was written
+        bool append = restarted && tp.step > 1;
+        if (append && energySize >= 0 &&
+            (!EnergyWriter::truncate(energFile,energySize) ||
+             !EnergyWriter::truncate(countFile,countSize)))
+          return false;
+
+        energy.reset(new EnergyWriter(energFile,binaryEnergy,energyFlush,
+                                      append));
+        countStream.close();
+        countStream.open(countFile,append ? std::ios::app : std::ios::out);
+      }
 
       const Vector& n1 = this->S1.getGlobalNorms();
       const Vector& n2 = this->S2.getGlobalNorms();
+      std::vector<double> row(n1.begin(),n1.end());
+      row.push_back(n2.size() > 2 ? n2[1] : 0.0);
+      row.push_back(n2.size() > 1 ? n2[n2.size()-2] : 0.0);
+      row.push_back(n2.size() > 0 ? n2.back() : 0.0);
+      if (!energy->write(tp.time.t,row))
+        return false;
 
-      os << std::setprecision(11) << std::setw(6) << std::scientific
-         << tp.time.t;
-      for (size_t i = 0; i < n1.size(); i++) os <<" "<< n1[i];
-      os <<" "<< (n2.size() > 2 ? n2[1] : 0.0);
-      os <<" "<< (n2.size() > 1 ? n2[n2.size()-2] : 0.0);
-      os <<" "<< (n2.size() > 0 ? n2.back() : 0.0);
-      os << std::endl;
+      // Performance counters of this step, next to the energy file
+      StepCounters::writeStep(countStream,tp.step,tp.time.t);
+      if (tp.step%energyFlush == 0)
+        countStream.flush();
+      if (!countStream)
+      {
+        std::cerr <<" *** SIMFracture::saveStep: Failed to write "
+                  << countFile << std::endl;
+        return false;
+      }
     }
+    else // The counts are per time step also when they are not written
+      StepCounters::reset();
+
+    bool ok = this->S2.saveStep(tp,nBlock) && this->S1.saveStep(tp,nBlock);
+
+    if (ok && chkInterval > 0 && tp.step > 0 && tp.step%chkInterval == 0 &&
+        this->S1.getProcessAdm().getProcId() == 0)
+    {
+      EventTracer::Span span("Checkpoint",tp.step);
+      ok = this->writeCheckpoint(tp);
+    }
+
+    // The step ends here, trace it from the start in advanceStep()
+    if (EventTracer::isEnabled() && tp.step > 0)
+      EventTracer::complete("Step",stepStart,tp.step);
 
-    return this->S2.saveStep(tp,nBlock) && this->S1.saveStep(tp,nBlock);
+    return ok;
   }
 
   //! \brief Assigns the file name for global energy output.
-  void setEnergyFile(const char* fName)
+  //! \param[in] fName Name of the energy file
+  //! \param[in] binary If \e true, use the binary format of EnergyWriter
+  //! \param[in] nflush Number of steps to buffer before writing to file
+  void setEnergyFile(const char* fName, bool binary = false, int nflush = 1)
   {
     if (fName)
     {
       energFile = fName;
-      IFEM::cout <<"\tFile for global energy output: "<< energFile << std::endl;
+      binaryEnergy = binary;
+      energyFlush = nflush > 0 ? nflush : 1;
+      countFile = energFile.substr(0,energFile.find_last_of('.'));
+      countFile += "_counters.jsonl";
+      IFEM::cout <<"\tFile for global energy output: "<< energFile
+                 << (binaryEnergy ? " (binary)" : "")
+                 <<"\n\tFile for step performance counters: "<< countFile
+                 << std::endl;
+    }
+  }
+
+  //! \brief Toggles whether the input file is parsed again after refinement.
+  //! \details By default, the parsed model properties are kept and only the
+  //! finite element data is regenerated for the refined mesh.
+  void setRereadInput(bool reread) { rereadInput = reread; }
+
+  //! \brief Assigns the file name for checkpoint output.
+  //! \param[in] fName Name of the checkpoint file
+  //! \param[in] interval Number of time steps between each checkpoint
+  void setCheckpointFile(const char* fName, int interval)
+  {
+    if (fName && interval > 0)
+    {
+      chkFile = fName;
+      chkInterval = interval;
+      IFEM::cout <<"\tFile for checkpoint output: "<< chkFile
+                 <<" (every "<< chkInterval <<" steps)"<< std::endl;
+    }
+  }
+
+  //! \brief Writes the coupled solution state to the checkpoint file.
+  //! \details The energy and counter files are flushed first, such that they
+  //! contain all steps up to the checkpoint.
+  bool writeCheckpoint(const TimeStep& tp)
+  {
+    if (energy && !energy->flush())
+      return false;
+    else if (countStream.is_open() && !countStream.flush())
+    {
+      std::cerr <<" *** SIMFracture::writeCheckpoint: Failed to write "
+                << countFile << std::endl;
+      return false;
+    }
+
+    std::map<std::string,std::string> tpData;
+    if (!tp.serialize(tpData))
+      return false;
+
+    CheckpointWriter chk(chkFile);
+    for (size_t i = 0; i < sols.size(); i++)
+      if (!chk.write("Fracture/sols" + std::to_string(i),sols[i]))
+        return false;
+
+    for (size_t i = 0; i < refinements.size(); i++)
+      if (!chk.write("Fracture/refinement" + std::to_string(i),refinements[i]))
+        return false;
+
+    if (!chk.write("TimeStep",tpData) ||
+        !chk.writeCount("Fracture/nsols",sols.size()) ||
+        !chk.writeCount("Fracture/nrefinements",refinements.size()) ||
+        !chk.write("Fracture/hsol",hsol) ||
+        !chk.write("Fracture/aMin",aMin) ||
+        !this->S1.writeCheckpoint(chk) || !this->S2.writeCheckpoint(chk))
+      return false;
+
+    // The sizes of the energy and counter files, to truncate them on restart
+    if (energy && (!chk.writeCount("Fracture/energySize",
+                                   energy->getFileSize()) ||
+                   !chk.writeCount("Fracture/countSize",countStream.tellp())))
+      return false;
+
+    IFEM::cout <<"  Writing checkpoint of step "<< tp.step
+               <<" to "<< chkFile << std::endl;
+    return chk.close();
+  }
+
+  //! \brief Restores the coupled solution state from a checkpoint file.
+  //! \param[in] fileName Name of the checkpoint file
+  //! \param[out] tp Time stepping parameters of the checkpoint
+  //! \details This method is to be invoked after the model has been set up
+  //! from the input file. The mesh refinements of the previous run are then
+  //! replayed from the recorded basis functions, without any solves, and the
+  //! initial refinement cycles are not repeated. The energy and counter files
+  //! are truncated to their sizes at the checkpoint before the first append.
+  bool restart(const std::string& fileName, TimeStep& tp)
+  {
+    CheckpointReader chk(fileName);
+    std::map<std::string,std::string> tpData;
+    if (!chk.isValid() || !chk.read("TimeStep",tpData) ||
+        !tp.deSerialize(tpData))
+      return false;
+
+    size_t nsols = 0, nrefs = 0;
+    if (!chk.readCount("Fracture/nsols",nsols) ||
+        !chk.readCount("Fracture/nrefinements",nrefs) ||
+        !chk.read("Fracture/hsol",hsol) ||
+        !chk.read("Fracture/aMin",aMin))
+      return false;
+
+    // Grow the arrays as the sections are read, such that a corrupt count
+    // fails on the first missing section instead of allocating the count
+    sols.clear();
+    for (size_t i = 0; i < nsols; i++)
+    {
+      sols.resize(i+1);
+      if (!chk.read("Fracture/sols" + std::to_string(i),sols.back()))
+        return false;
+    }
+
+    size_t eSize = 0, cSize = 0;
+    if (chk.has("Fracture/energySize"))
+    {
+      if (!chk.readCount("Fracture/energySize",eSize) ||
+          !chk.readCount("Fracture/countSize",cSize))
+        return false;
+      energySize = eSize;
+      countSize = cSize;
+    }
+
+    refinements.clear();
+    for (size_t i = 0; i < nrefs; i++)
+    {
+      refinements.resize(i+1);
+      std::string name("Fracture/refinement" + std::to_string(i));
+      if (!chk.read(name,refinements.back()))
+        return false;
+    }
+
+    if (!refinements.empty())
+    {
+#ifdef HAS_LRSPLINE
+      IFEM::cout <<"\nReplaying "<< refinements.size()
+                 <<" mesh refinements from "<< fileName << std::endl;
+      for (const IntVec& functions : refinements)
+      {
+        LR::RefineData prm = refineData(functions);
+        if (!this->S1.refine(prm) || !this->S2.refine(prm))
+          return false;
+      }
+
+      if (this->reinitialize() < 0)
+        return false;
+#else
+      std::cerr <<" *** SIMFractureDynamics::restart: No LR-spline support."
+                << std::endl;
+      return false;
+#endif
     }
+
+    if (!this->S1.readCheckpoint(chk) || !this->S2.readCheckpoint(chk,tp.step))
+      return false;
+
+    IFEM::cout <<"\nRestarted from "<< fileName <<" at step "<< tp.step
+               <<" time="<< tp.time.t << std::endl;
+    restarted = true;
+    return true;
   }
 
   //! \brief Stores current solution state in an internal buffer.
@@ -97,7 +308,9 @@ public:
   //! \brief Refines the mesh on the initial configuration.
   bool initialRefine(double beta, double min_frac, int nrefinements)
   {
-    if (this->S2.getInitRefine() >= nrefinements)
+    if (restarted)
+      return true; // The refinements were replayed from the checkpoint
+    else if (this->S2.getInitRefine() >= nrefinements)
       return true; // Grid is sufficiently refined during input parsing
 
     TimeStep step0;
@@ -114,6 +327,7 @@ public:
   //! \brief Refines the mesh with transfer of solution onto the new mesh.
   int adaptMesh(double beta, double min_frac, int nrefinements)
   {
+    EventTracer::Span span("Mesh adaptation");
 #ifdef HAS_LRSPLINE
     ASMu2D* pch = dynamic_cast<ASMu2D*>(this->S1.getPatch(1));
     if (!pch)
@@ -154,6 +368,8 @@ public:
     if (elements.empty())
       return 0;
 
+    StepCounters::add(StepCounters::REFINED_ELEMENTS,elements.size());
+
     IFEM::cout <<"  Elements to refine: "<< elements.size()
                <<" (|c| = ["<< eNorm[elements.front()]
                <<","<< eNorm[elements.back()] <<"])\n"<< std::endl;
@@ -162,27 +378,22 @@ public:
     if (!hsol.empty()) oldBasis = pch->getBasis()->copy();
 
     // Do the mesh refinement
-    LR::RefineData prm;
-    prm.options = { 10, 1, 2, 0, 1 };
-    prm.elements = pch->getFunctionsForElements(elements);
-    if (!this->S1.refine(prm,sols) || !this->S2.refine(prm))
-      return -2;
-
-    // Re-initialize the simulators for the new mesh
-    this->S1.clearProperties();
-    this->S2.clearProperties();
-    if (!this->S1.read(infile.c_str()) || !this->S2.read(infile.c_str()))
-      return -3;
+    LR::RefineData prm = refineData(pch->getFunctionsForElements(elements));
+    {
+      // The phase-field patches are clones sharing the basis and the element
+      // connectivity with the elasticity patches. The basis is refined and
+      // all solutions are transferred by the first call, the second call only
+      // updates the patch sizes of the phase-field model.
+      StepCounters::Timing timing(StepCounters::MESH_REFINEMENT);
+      if (!this->S1.refine(prm,sols) || !this->S2.refine(prm))
+        return -2;
+    }
 
-    if (!this->preprocess())
-      return -4;
+    refinements.push_back(prm.elements);
 
-    if (!this->init(TimeStep()))
-      return -5;
-
-    if (!this->S1.initSystem(this->S1.opt.solver) ||
-        !this->S2.initSystem(this->S2.opt.solver,1,1,false))
-      return -6;
+    int status = this->reinitialize();
+    if (status < 0)
+      return status;
 
     // Transfer solution variables onto the new mesh
     if (!sols.empty())
@@ -211,12 +422,100 @@ public:
   }
 
 private:
-  std::string energFile; //!< File name for global energy output
+  //! \brief Re-initializes the simulators after a mesh refinement.
+  //! \return Negative value on failure
+  //!
+  //! \details The nodal numbering, element connectivities and constraints of
+  //! the patches are regenerated for the refined basis, whereas the parsed
+  //! properties, functions, materials and integrands are kept. The properties
+  //! refer to patch entities, and are therefore valid also for the refined
+  //! mesh. If \a rereadInput is set, the input file is parsed again instead.
+  //!
+  //! The equation systems are rebuilt from scratch, since the sparsity
+  //! pattern and the equation numbering are owned by the linear algebra
+  //! backend. The time spent in each part is reported by the step counters.
+  int reinitialize()
+  {
+    {
+      StepCounters::Timing timing(StepCounters::MESH_NUMBERING);
+      EventTracer::Span span("Mesh numbering");
+      if (rereadInput)
+      {
+        this->S1.clearProperties();
+        this->S2.clearProperties();
+        if (!this->S1.read(infile.c_str()) || !this->S2.read(infile.c_str()))
+          return -3;
+      }
+      else
+      {
+        ASMstruct::resetNumbering();
+        for (ASMbase* pch : this->S1.getFEModel())
+          pch->clear(true); // retain the geometry only
+        for (ASMbase* pch : this->S2.getFEModel())
+          pch->clear(true);
+      }
+
+      if (!this->preprocess())
+        return -4;
+
+      // Both simulators must be on the same (shared) refined grid
+      if (this->S1.getNoNodes() != this->S2.getNoNodes())
+      {
+        std::cerr <<" *** SIMFractureDynamics::reinitialize: The grids of "
+                  << this->S1.getName() <<" and "<< this->S2.getName()
+                  <<" differ after refinement ("<< this->S1.getNoNodes()
+                  <<" and "<< this->S2.getNoNodes() <<" nodes)."<< std::endl;
+        return -4;
+      }
+    }
+
+    StepCounters::Timing timing(StepCounters::MESH_SYSTEM);
+    EventTracer::Span span("Equation system setup");
+    if (!this->init(TimeStep()))
+      return -5;
+
+    if (!this->S1.initSystem(this->S1.opt.solver) ||
+        !this->S2.initSystem(this->S2.opt.solver,1,1,false))
+      return -6;
+
+    // The stored phase-field operators refer to the old mesh
+    this->S2.clearStationaryOperators();
+    return 0;
+  }
+
+#ifdef HAS_LRSPLINE
+  //! \brief Returns the refinement parameters for the given basis functions.
+  //! \details The same parameters are used by adaptMesh() and when replaying
+  //! the refinements on restart, such that the same mesh is obtained.
+  static LR::RefineData refineData(const IntVec& functions)
+  {
+    LR::RefineData prm;
+    prm.options = { 10, 1, 2, 0, 1 };
+    prm.elements = functions;
+    return prm;
+  }
+#endif
+
   std::string infile;    //!< Input file parsed
+  std::string energFile; //!< File name for global energy output
+  std::string countFile; //!< File name for step performance counters
+  bool        binaryEnergy; //!< If \e true, the energy file is binary
+  int         energyFlush;  //!< Number of steps between energy file writes
+  std::streamoff energySize; //!< Energy file size at restart checkpoint
+  std::streamoff countSize;  //!< Counter file size at restart checkpoint
+  std::string chkFile;   //!< File name for checkpoint output
+  int         chkInterval; //!< Number of steps between checkpoints
+  bool        restarted;   //!< If \e true, the run continues a checkpoint
+  bool        rereadInput; //!< If \e true, parse the input after refinement
 
   double    aMin; //!< Minimum element area
+  EventTracer::Clock::time_point stepStart; //!< Start time of current step
   Vectors   sols; //!< Solution state to transfer onto refined mesh
   RealArray hsol; //!< History field to transfer onto refined mesh
+  std::vector<IntVec> refinements; //!< Refined basis functions of each mesh
+
+  std::unique_ptr<EnergyWriter> energy; //!< Energy file writer
+  std::ofstream countStream; //!< Performance counter file
 };
 
 #endif
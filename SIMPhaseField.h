@@ -16,6 +16,10 @@
 
 #include "InitialConditionHandler.h"
 #include "CahnHilliard.h"
+#include "StepCounters.h"
+#include "EventTracer.h"
+#include "Checkpoint.h"
+#include "SystemMatrix.h"
 #ifdef HAS_LRSPLINE
 #include "ASMu2D.h"
 #endif
@@ -25,6 +29,8 @@
 #include "DataExporter.h"
 #include "IFEM.h"
 #include "tinyxml.h"
+#include <algorithm>
+#include <memory>
 
 
 /*!
@@ -43,6 +49,7 @@ public:
 
     eps_d0 = refTol = 0.0;
     vtfStep = Lnorm = irefine = 0;
+    reuseStationary = true;
   }
 
   //! \brief Empty destructor.
@@ -97,6 +104,7 @@ public:
   bool saveStep(const TimeStep& tp, int& nBlock)
   {
     PROFILE1("SIMPhaseField::saveStep");
+    EventTracer::Span span("Phase-field output",tp.step);
 
     double old = utl::zero_print_tol;
     utl::zero_print_tol = 1e-16;
@@ -147,15 +155,27 @@ public:
                  <<" time="<< tp.time.t << std::endl;
 
     if (tp.step == 0 && tp.iter > 0) // Hack: Reduce the smearing factor
-      // by a factor of 1/2 after each initial mesh refinement (at step=0)
+    { // by a factor of 1/2 after each initial mesh refinement (at step=0)
       static_cast<CahnHilliard*>(Dim::myProblem)->scaleSmearing(0.5);
+      this->clearStationaryOperators();
+    }
+
+    StepCounters::add(StepCounters::COUPLING_ITER);
 
     this->setMode(SIM::STATIC);
-    if (!this->assembleSystem())
-      return false;
+    {
+      StepCounters::Timing timing(StepCounters::PHASEFIELD_ASSEMBLY);
+      EventTracer::Span span("Phase-field assembly",tp.step);
+      if (!this->assemblePhaseSystem())
+        return false;
+    }
 
-    if (!this->solveSystem(phasefield,0))
-      return false;
+    {
+      StepCounters::Timing timing(StepCounters::PHASEFIELD_SOLVE);
+      EventTracer::Span span("Phase-field solve",tp.step);
+      if (!this->solveSystem(phasefield,0))
+        return false;
+    }
 
     if (tp.step == 1)
       static_cast<CahnHilliard*>(Dim::myProblem)->clearInitialCrack();
@@ -172,14 +192,20 @@ public:
 
     // Project the phase field onto the geometry basis
     if (!Dim::opt.project.empty())
+    {
+      EventTracer::Span span("Phase-field projection",tp.step);
       if (!this->project(projSol,phasefield,Dim::opt.project.begin()->first))
         return false;
+    }
 
     Vectors gNorm;
     this->setQuadratureRule(Dim::opt.nGauss[1]);
-    if (!this->solutionNorms(tp.time,Vectors(1,phasefield),gNorm,&eNorm))
-      return false;
-    else if (!gNorm.empty())
+    {
+      EventTracer::Span span("Phase-field norms",tp.step);
+      if (!this->solutionNorms(tp.time,Vectors(1,phasefield),gNorm,&eNorm))
+        return false;
+    }
+    if (!gNorm.empty())
     {
       norm = gNorm.front();
       norm.push_back(norm.back());
@@ -249,6 +275,63 @@ public:
   //! \brief Updates the solution vector.
   void setSolution(const Vector& vec) { phasefield = vec; }
 
+  //! \brief Writes the solution state to a checkpoint file.
+  bool writeCheckpoint(CheckpointWriter& chk) const
+  {
+    const CahnHilliard* chp = static_cast<const CahnHilliard*>(Dim::myProblem);
+    return chk.write("PhaseField/solution",phasefield) &&
+           chk.write("PhaseField/history",chp->historyField) &&
+           chk.write("PhaseField/norms",norm) &&
+           chk.write("PhaseField/eps_d0",eps_d0) &&
+           chk.write("PhaseField/smearing",chp->getSmearingFactor());
+  }
+
+  //! \brief Restores the solution state from a checkpoint file.
+  //! \param[in] chk The checkpoint file
+  //! \param[in] step Time step of the checkpoint
+  //! \details The model must have been refined to the mesh of the checkpoint.
+  bool readCheckpoint(const CheckpointReader& chk, int step)
+  {
+    CahnHilliard* chp = static_cast<CahnHilliard*>(Dim::myProblem);
+    size_t nHist = 0;
+    double smearing = 0.0;
+    const double* history = chk.getDoubles("PhaseField/history",nHist);
+    if (!history ||
+        !chk.read("PhaseField/solution",phasefield) ||
+        !chk.read("PhaseField/norms",norm) ||
+        !chk.read("PhaseField/eps_d0",eps_d0) ||
+        !chk.read("PhaseField/smearing",smearing))
+      return false;
+
+    if (phasefield.size() != this->getNoDOFs() ||
+        nHist != chp->historyField.size())
+    {
+      std::cerr <<" *** SIMPhaseField::readCheckpoint: The checkpoint does not"
+                <<" match the model ("<< phasefield.size() <<" dofs, "
+                << nHist <<" history values)."<< std::endl;
+      return false;
+    }
+
+    // Copy the history field directly from the mapped checkpoint file
+    std::copy(history,history+nHist,chp->historyField.begin());
+    chp->setSmearingFactor(smearing);
+    if (step >= 1)
+      chp->clearInitialCrack();
+
+    // The stationary operators depend on the smearing factor
+    this->clearStationaryOperators();
+    return true;
+  }
+
+  //! \brief Deletes the stationary system operators.
+  //! \details This has to be invoked whenever the mesh or the equation system
+  //! is changed, such that the stationary operators are reassembled.
+  void clearStationaryOperators()
+  {
+    stationaryA.reset();
+    stationaryB.reset();
+  }
+
   //! \brief Returns the maximum number of iterations (unlimited).
   int getMaxit() const { return 9999; }
   //! \brief Returns the number of initial refinement cycles.
@@ -294,6 +377,64 @@ public:
 #endif
 
 protected:
+  //! \brief Assembles the linear system of the phase-field problem.
+  //! \details The history-independent part of the system (the unit mass
+  //! matrix, the gradient terms and the right-hand-side vector) is assembled
+  //! only once and stored. In the following time steps, only the mass matrix
+  //! weighted by the history field is assembled, and the stored operators are
+  //! then added to the system. If the system matrix type does not support
+  //! matrix addition, the full system is assembled instead.
+  bool assemblePhaseSystem()
+  {
+    CahnHilliard* chp = static_cast<CahnHilliard*>(Dim::myProblem);
+    SystemMatrix* A = this->getLHSmatrix();
+    SystemVector* b = this->getRHSvector();
+    if (!A || !b)
+      reuseStationary = false;
+
+    if (reuseStationary && stationaryA)
+      if (stationaryA->dim() != A->dim() || stationaryB->dim() != b->dim())
+        this->clearStationaryOperators(); // The equation system has changed
+
+    if (reuseStationary && !stationaryA)
+    {
+      chp->setAssemblyPart(CahnHilliard::STATIONARY);
+      bool ok = this->assembleSystem();
+      chp->setAssemblyPart(CahnHilliard::FULL);
+      if (!ok) return false;
+
+      stationaryA.reset(this->getLHSmatrix(0,true));
+      stationaryB.reset(this->getRHSvector(0,true));
+      if (!stationaryA || !stationaryB)
+      {
+        this->clearStationaryOperators();
+        reuseStationary = false;
+      }
+    }
+
+    if (reuseStationary)
+    {
+      chp->setAssemblyPart(CahnHilliard::HISTORY);
+      bool ok = this->assembleSystem();
+      chp->setAssemblyPart(CahnHilliard::FULL);
+      if (!ok) return false;
+
+      if (A->add(*stationaryA))
+      {
+        b->add(*stationaryB);
+        return true;
+      }
+
+      IFEM::cout <<"  ** SIMPhaseField: The system matrix does not support"
+                 <<" addition, the full system is assembled in each step."
+                 << std::endl;
+      this->clearStationaryOperators();
+      reuseStationary = false;
+    }
+
+    return this->assembleSystem();
+  }
+
   using Dim::parse;
   //! \brief Parses a data section from an XML element.
   virtual bool parse(const TiXmlElement* elem)
@@ -363,6 +504,10 @@ private:
   int    Lnorm;      //!< Which L-norm to use to guide mesh refinement
   int    irefine;    //!< Number of initial refinement cycles
   double refTol;     //!< Initial refinement threshold
+
+  std::unique_ptr<SystemMatrix> stationaryA; //!< History-independent matrix
+  std::unique_ptr<SystemVector> stationaryB; //!< History-independent RHS
+  bool reuseStationary; //!< If \e false, always assemble the full system
 };
 
 #endif
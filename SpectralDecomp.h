@@ -0,0 +1,108 @@
+// $Id$
+//==============================================================================
+//!
+//! \file SpectralDecomp.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author SINTEF
+//!
+//! \brief Closed-form spectral decomposition of symmetric 2x2 and 3x3 tensors.
+//!
+//==============================================================================
+
+#ifndef _SPECTRAL_DECOMP_H
+#define _SPECTRAL_DECOMP_H
+
+#include "Vec3.h"
+
+class SymmTensor;
+
+
+/*!
+  \brief Class representing the spectral decomposition of a symmetric tensor.
+
+  \details The principal values are computed in closed form, using the
+  analytic solution in 2D and the trigonometric solution of the characteristic
+  cubic in 3D. In 3D, the eigenvector of the well-separated principal value is
+  found from cross products of the rows of the shifted tensor, whereas the
+  remaining two are obtained from a 2x2 problem in the orthogonal plane.
+  Principal values that coincide within round-off are made exactly equal.
+
+  The eigenprojections are stored in fixed-size arrays using the same
+  component ordering as the SymmTensor class, i.e., (11,22,12) in 2D and
+  (11,22,33,12,23,13) in 3D, such that no heap allocation takes place.
+*/
+
+class SpectralDecomp
+{
+public:
+  //! \brief The constructor initializes the number of spatial dimensions.
+  explicit SpectralDecomp(unsigned short int n) : nsd(n) {}
+
+  //! \brief Computes the principal values and eigenprojections of a tensor.
+  //! \param[in] A The symmetric tensor to decompose
+  bool compute(const SymmTensor& A);
+  //! \brief Computes the principal values and eigenprojections of a tensor.
+  //! \param[in] A Unique tensor components, in SymmTensor order
+  bool compute(const double* A);
+
+  //! \brief Returns the principal values, in descending order.
+  const Vec3& values() const { return p; }
+
+  //! \brief Returns component (i,j) of eigenprojection \a a.
+  //! \details The projection index \a a is 0-based, consistent with the
+  //! principal values, whereas the component indices \a i and \a j are
+  //! 1-based, consistent with the Tensor classes.
+  double operator()(unsigned short int a,
+                    unsigned short int i, unsigned short int j) const
+  {
+    return M[a][index(nsd,i,j)];
+  }
+
+  //! \brief Returns a pointer to the unique components of projection \a a.
+  const double* ptr(unsigned short int a) const { return M[a]; }
+
+  //! \brief Adds a scaled eigenprojection to a symmetric tensor.
+  //! \param T The tensor to add to
+  //! \param[in] a 0-based index of the eigenprojection to add
+  //! \param[in] s Scaling factor
+  void addTo(SymmTensor& T, unsigned short int a, double s) const;
+
+  //! \brief Returns the 0-based storage index of tensor component (i,j).
+  static unsigned short int index(unsigned short int n,
+                                  unsigned short int i, unsigned short int j)
+  {
+    static const unsigned short int i2[2][2] = {{0,2},{2,1}};
+    static const unsigned short int i3[3][3] = {{0,3,5},{3,1,4},{5,4,2}};
+    return n > 2 ? i3[i-1][j-1] : (n > 1 ? i2[i-1][j-1] : 0);
+  }
+
+  //! \brief Returns the 1-based tensor indices of a storage position.
+  //! \param[in] n Number of spatial dimensions
+  //! \param[in] k 1-based storage (Voigt) index
+  //! \param[out] i First tensor index
+  //! \param[out] j Second tensor index
+  static void indices(unsigned short int n, unsigned short int k,
+                      unsigned short int& i, unsigned short int& j)
+  {
+    static const unsigned short int i2[3][2] = {{1,1},{2,2},{1,2}};
+    static const unsigned short int i3[6][2] = {{1,1},{2,2},{3,3},
+                                                {1,2},{2,3},{1,3}};
+    const unsigned short int* ij = n > 2 ? i3[k-1] : i2[k-1];
+    i = ij[0];
+    j = ij[1];
+  }
+
+private:
+  //! \brief Closed-form solution of the 2x2 problem.
+  bool compute2D(const double* A);
+  //! \brief Trigonometric solution of the 3x3 problem.
+  bool compute3D(const double* A);
+
+  unsigned short int nsd; //!< Number of spatial dimensions
+  Vec3   p;               //!< Principal values, in descending order
+  double M[3][6];         //!< Eigenprojections, in SymmTensor component order
+};
+
+#endif
@@ -0,0 +1,93 @@
+// $Id$
+//==============================================================================
+//!
+//! \file StepCounters.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author SINTEF
+//!
+//! \brief Performance counters of the fracture simulators, per time step.
+//!
+//==============================================================================
+
+#ifndef _STEP_COUNTERS_H
+#define _STEP_COUNTERS_H
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+
+/*!
+  \brief Counters and timers of what the solvers did in a time step.
+
+  \details The counters are incremented by the integrands and the solution
+  drivers, and are reset once per time step, by writeStep() or reset().
+  Each thread increments its own set of counters, such that the integration
+  point methods can count without synchronization. The counts of all threads
+  are summed by get(), which therefore must not be called while an element
+  loop is running. The timers are only used by the main thread.
+*/
+
+class StepCounters
+{
+public:
+  //! \brief The counted quantities.
+  enum Counter {
+    STRESS_FREE,     //!< Stress evaluations with zero volumetric strain
+    HYDROSTATIC,     //!< Stress evaluations with coinciding principal values
+    SPECTRAL,        //!< Stress evaluations with a full spectral split
+    DECOMP_FAILED,   //!< Failed principal strain decompositions
+    STATE_CACHE_HITS,//!< Points post-processed from the state cache
+    NEWTON_ITER,     //!< Newton iterations of the elasticity solver
+    COUPLING_ITER,   //!< Staggered coupling iterations
+    REFINED_ELEMENTS,//!< Elements refined by mesh adaptation
+    NCOUNTER         //!< Number of counters
+  };
+
+  //! \brief The timed operations.
+  enum Timer {
+    ELASTICITY_NEWTON,   //!< Newton iterations, including the assembly
+    PHASEFIELD_ASSEMBLY, //!< Assembly of the phase-field linear system
+    PHASEFIELD_SOLVE,    //!< Solution of the phase-field linear system
+    MESH_REFINEMENT,     //!< LR refinement including solution transfer
+    MESH_NUMBERING,      //!< Regeneration of the nodal numbering and topology
+    MESH_SYSTEM,         //!< Set up of the equation systems on a refined mesh
+    NTIMER               //!< Number of timers
+  };
+
+  //! \brief Scope guard adding the elapsed wall time to a timer.
+  class Timing
+  {
+  public:
+    //! \brief The constructor starts the timing.
+    explicit Timing(Timer t) : timer(t), t0(std::chrono::steady_clock::now()) {}
+    //! \brief The destructor adds the elapsed time to the timer.
+    ~Timing();
+
+  private:
+    Timer timer; //!< The timer to add to
+    std::chrono::steady_clock::time_point t0; //!< Start time
+  };
+
+  //! \brief Increments a counter of the calling thread.
+  static void add(Counter c, size_t n = 1);
+  //! \brief Adds to a timer.
+  static void addTime(Timer t, double seconds);
+
+  //! \brief Returns the count of all threads since the last reset.
+  static size_t get(Counter c);
+  //! \brief Returns the accumulated time (in seconds) since the last reset.
+  static double getTime(Timer t);
+  //! \brief Resets all counters and timers.
+  static void reset();
+
+  //! \brief Writes the counters of a time step as one JSON line, and resets.
+  //! \param os The output stream to write to
+  //! \param[in] step Time step counter
+  //! \param[in] time Current time
+  static void writeStep(std::ostream& os, int step, double time);
+};
+
+#endif
@@ -0,0 +1,88 @@
+// $Id$
+//==============================================================================
+//!
+//! \file SymmTensor4.h
+//!
+//! \date Oct 15 2026
+//!
+//! \author SINTEF
+//!
+//! \brief Compact representation of symmetric fourth-order tensors.
+//!
+//==============================================================================
+
+#ifndef _SYMM_TENSOR4_H
+#define _SYMM_TENSOR4_H
+
+#include "SpectralDecomp.h"
+#include <iostream>
+
+
+/*!
+  \brief Class representing a fourth-order tensor with minor and major symmetry.
+
+  \details Only the components (ij,kl) with unique index pairs ij and kl are
+  stored, as an NSTRCxNSTRC matrix in Voigt notation with the index pairs
+  ordered as in the SymmTensor class, i.e., (11,22,12) in 2D and
+  (11,22,33,12,23,13) in 3D. This is 36 values in 3D instead of 81, and the
+  storage is a fixed-size array such that no heap allocation takes place.
+  The components are stored row-wise, which coincides with the column-wise
+  storage of the Matrix class due to the major symmetry. The array is
+  therefore directly usable as a constitutive matrix in Voigt notation.
+*/
+
+class SymmTensor4
+{
+public:
+  //! \brief The constructor creates a volumetric tensor.
+  //! \param[in] n Number of spatial dimensions
+  //! \param[in] C0 Value of all components (ii,jj)
+  explicit SymmTensor4(unsigned short int n, double C0 = 0.0);
+
+  //! \brief Returns the number of spatial dimensions.
+  unsigned short int dim() const { return nsd; }
+  //! \brief Returns the number of unique index pairs.
+  unsigned short int size() const { return nstrc; }
+
+  //! \brief Returns Voigt component (is,js), 1-based.
+  double& operator()(unsigned short int is, unsigned short int js)
+  {
+    return C[nstrc*(is-1)+js-1];
+  }
+  //! \brief Returns Voigt component (is,js), 1-based.
+  double operator()(unsigned short int is, unsigned short int js) const
+  {
+    return C[nstrc*(is-1)+js-1];
+  }
+
+  //! \brief Returns tensor component (i,j,k,l), 1-based.
+  double& operator()(unsigned short int i, unsigned short int j,
+                     unsigned short int k, unsigned short int l)
+  {
+    return C[nstrc*SpectralDecomp::index(nsd,i,j)+
+             SpectralDecomp::index(nsd,k,l)];
+  }
+  //! \brief Returns tensor component (i,j,k,l), 1-based.
+  double operator()(unsigned short int i, unsigned short int j,
+                    unsigned short int k, unsigned short int l) const
+  {
+    return C[nstrc*SpectralDecomp::index(nsd,i,j)+
+             SpectralDecomp::index(nsd,k,l)];
+  }
+
+  //! \brief Returns a pointer to the Voigt matrix, for use in contractions.
+  const double* ptr() const { return C; }
+
+  //! \brief Copies the lower triangle of the Voigt matrix to the upper one.
+  void symmetrize();
+
+private:
+  unsigned short int nsd;   //!< Number of spatial dimensions
+  unsigned short int nstrc; //!< Number of unique index pairs
+  double C[36];             //!< Voigt matrix of unique components
+};
+
+//! \brief Print out a symmetric fourth-order tensor to the given stream.
+std::ostream& operator<<(std::ostream& os, const SymmTensor4& T);
+
+#endif
@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+# $Id$
+#==============================================================================
+#!
+#! \file perftest.py
+#!
+#! \date Oct 15 2026
+#!
+#! \author SINTEF
+#!
+#! \brief Performance regression test driver for the fracture applications.
+#!
+#==============================================================================
+#
+# Runs one application on a scaled-up variant of an input file, and records
+# the total wall time, the wall time of each profiled task and the peak
+# resident set size in a JSON file. If a baseline file with an entry for the
+# case exists, the run fails when any of the recorded figures exceeds the
+# baseline value by more than the given margin.
+#
+# Usage: perftest.py <case> <app> <input> [options] [-- <app options>]
+#   --scale <n>        Multiply the number of elements by n (default 1)
+#   --steps <n>        Limit the simulation to n time steps
+#   --baseline <file>  Baseline file to check against or update
+#   --margin <f>       Allowed relative increase (default 0.25, or the
+#                      FRACTURE_PERF_MARGIN environment variable)
+#   --min-time <t>     Tasks faster than t seconds are not checked (0.5)
+#   --update-baseline  Store the results as the new baseline of the case,
+#                      also done if FRACTURE_PERF_UPDATE_BASELINE is set
+
+import argparse
+import json
+import os
+import re
+import resource
+import subprocess
+import sys
+import time
+
+
+def scale_input(text, scale, steps):
+    """Returns the input file text with the refinement scaled by the given
+    element count factor, and with the time interval limited to steps."""
+
+    def refine(match):
+        attrs = dict(re.findall(r'(\w+)="([^"]*)"', match.group(0)))
+        dirs = [d for d in 'uvw' if d in attrs]
+        factor = round(scale ** (1.0 / len(dirs))) if dirs else 1
+        if dirs and factor ** len(dirs) != scale:
+            sys.exit(' *** perftest: scale %d is not a power of %d'
+                     % (scale, len(dirs)))
+        result = match.group(0)
+        for d in dirs:
+            nel = (int(attrs[d]) + 1) * factor - 1
+            result = re.sub(r'\b%s="\d+"' % d, '%s="%d"' % (d, nel), result)
+        return result
+
+    def step(match):
+        start = float(match.group(1))
+        dt = float(match.group(3))
+        return '<step start="%s" end="%g">%s</step>' \
+            % (match.group(1), start + steps * dt, match.group(3))
+
+    if scale > 1:
+        text = re.sub(r'<refine\s[^>]*type="uniform"[^>]*/>', refine, text)
+    if steps:
+        text = re.sub(r'<step\s+start="([^"]*)"\s+end="([^"]*)">'
+                      r'\s*([^<\s]*)\s*</step>', step, text)
+    return text
+
+
+def parse_profile(log):
+    """Extracts the wall time of each task from the Profiler report.
+    The report is a fixed-width table, and the wall time of a task is the
+    first number ending at or after the start of the "Wall" column header."""
+
+    phases = {}
+    column = None
+    number = re.compile(r'[-+]?\d+(?:\.\d*)?(?:[eE][-+]?\d+)?')
+    for line in log.splitlines():
+        if column is None:
+            if 'Wall' in line:
+                column = line.index('Wall')
+            continue
+        match = number.search(line)
+        if not match or not line[:match.start()].strip(' |:'):
+            if not line.strip() and phases:
+                break  # end of the table
+            continue
+        name = line[:match.start()].strip(' |:-')
+        for m in number.finditer(line):
+            if m.end() > column:
+                phases[name] = float(m.group(0))
+                break
+    return phases
+
+
+def check(result, base, margin, min_time):
+    """Returns a list of the figures exceeding the baseline."""
+
+    failures = []
+
+    def compare(label, value, ref, unit):
+        if ref and value > ref * (1.0 + margin):
+            failures.append('%s: %g %s (baseline %g %s, +%.0f%%)'
+                            % (label, value, unit, ref, unit,
+                               100.0 * (value / ref - 1.0)))
+
+    compare('wall time', result['wall_time'], base.get('wall_time'), 's')
+    compare('peak RSS', result['peak_rss_kb'], base.get('peak_rss_kb'), 'kB')
+    for name, ref in base.get('phases', {}).items():
+        if ref >= min_time and name in result['phases']:
+            compare(name, result['phases'][name], ref, 's')
+    return failures
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('case')
+    parser.add_argument('app')
+    parser.add_argument('input')
+    parser.add_argument('--scale', type=int, default=1)
+    parser.add_argument('--steps', type=int, default=0)
+    parser.add_argument('--baseline')
+    parser.add_argument('--margin', type=float,
+                        default=float(os.environ.get('FRACTURE_PERF_MARGIN',
+                                                     0.25)))
+    parser.add_argument('--min-time', type=float, default=0.5)
+    parser.add_argument('--update-baseline', action='store_true',
+                        default=bool(os.environ.get(
+                            'FRACTURE_PERF_UPDATE_BASELINE')))
+    argv = sys.argv[1:]
+    options = argv[argv.index('--') + 1:] if '--' in argv else []
+    args = parser.parse_args(argv[:argv.index('--')] if '--' in argv
+                             else argv)
+
+    with open(args.input) as f:
+        text = scale_input(f.read(), args.scale, args.steps)
+    infile = args.case + '.xinp'
+    with open(infile, 'w') as f:
+        f.write(text)
+
+    t0 = time.monotonic()
+    run = subprocess.run([args.app, infile] + options,
+                         stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                         universal_newlines=True)
+    wall = time.monotonic() - t0
+    with open(args.case + '.log', 'w') as f:
+        f.write(run.stdout)
+
+    # ru_maxrss is the largest of the waited-for children, i.e., this run
+    rss = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss
+    result = {'case': args.case,
+              'command': [os.path.basename(args.app), infile] + options,
+              'scale': args.scale,
+              'steps': args.steps,
+              'returncode': run.returncode,
+              'wall_time': wall,
+              'peak_rss_kb': rss,
+              'phases': parse_profile(run.stdout)}
+    with open(args.case + '.json', 'w') as f:
+        json.dump(result, f, indent=2, sort_keys=True)
+
+    print('%s: %.3f s, %d kB peak RSS' % (args.case, wall, rss))
+    for name, t in sorted(result['phases'].items()):
+        print('  %-40s %10.3f s' % (name, t))
+
+    if run.returncode != 0:
+        print(' *** perftest: %s failed with exit code %d, see %s.log'
+              % (args.app, run.returncode, args.case))
+        return 1
+
+    baseline = {}
+    if args.baseline and os.path.isfile(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    if args.update_baseline:
+        if not args.baseline:
+            sys.exit(' *** perftest: no baseline file given')
+        baseline[args.case] = {k: result[k] for k in
+                               ('wall_time', 'peak_rss_kb', 'phases')}
+        with open(args.baseline, 'w') as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+        print('  Baseline of %s updated in %s' % (args.case, args.baseline))
+        return 0
+
+    if args.case not in baseline:
+        print('  ** No baseline for %s, results are only recorded.' % args.case)
+        return 0
+
+    failures = check(result, baseline[args.case], args.margin, args.min_time)
+    for failure in failures:
+        print(' *** perftest: %s exceeds the baseline: %s'
+              % (args.case, failure))
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())